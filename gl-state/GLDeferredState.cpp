@@ -0,0 +1,36 @@
+
+#include "GLDeferredState.hpp"
+
+namespace CPM_GL_STATE_NS {
+
+//------------------------------------------------------------------------------
+GLDeferredState::GLDeferredState() :
+    mHasFlushed(false)
+{
+}
+
+//------------------------------------------------------------------------------
+void GLDeferredState::setFlushedState(const GLState& state)
+{
+  mFlushed    = state;
+  mHasFlushed = true;
+}
+
+//------------------------------------------------------------------------------
+bool GLDeferredState::isDirty() const
+{
+  return !mHasFlushed || !(mPending == mFlushed);
+}
+
+//------------------------------------------------------------------------------
+void GLDeferredState::flush()
+{
+  if (mHasFlushed)
+    mPending.applyRelative(mFlushed);
+  else
+    mPending.apply();
+
+  setFlushedState(mPending);
+}
+
+} // namespace CPM_GL_STATE_NS
@@ -0,0 +1,81 @@
+
+#ifndef IAUNS_GL_DEFERRED_STATE_H
+#define IAUNS_GL_DEFERRED_STATE_H
+
+#include "GLState.hpp"
+
+namespace CPM_GL_STATE_NS {
+
+// Records state changes against a pending GLState without touching OpenGL.
+// Nothing is sent to OpenGL until flush() is called, which should happen
+// immediately before each draw call. Only the net difference between the
+// pending state and the last flushed state is applied, so intermediate
+// changes made between two draws never reach the driver.
+
+class GLDeferredState
+{
+public:
+
+  /// The flushed state starts out unknown. The first flush() will apply the
+  /// entire pending state unless setFlushedState is called beforehand.
+  GLDeferredState();
+
+  /// State that will be applied on the next flush(). Read-only: do not
+  /// call the apply... family of functions on it. If OpenGL state is
+  /// modified outside of flush(), call invalidate().
+  const GLState&  getPending() const      {return mPending;}
+
+  /// Functions for recording changes to the pending state. See GLState for
+  /// a description of each value.
+  /// @{
+  void    setDepthTestEnable(bool value)  {mPending.setDepthTestEnable(value);}
+  void    setDepthFunc(GLenum value)      {mPending.setDepthFunc(value);}
+  void    setCullFace(GLenum value)       {mPending.setCullFace(value);}
+  void    setCullFaceEnable(bool value)   {mPending.setCullFaceEnable(value);}
+  void    setFrontFace(GLenum value)      {mPending.setFrontFace(value);}
+  void    setBlendEnable(bool value)      {mPending.setBlendEnable(value);}
+  void    setBlendEquation(GLenum value)  {mPending.setBlendEquation(value);}
+  void    setBlendFunction(GLenum src, GLenum dest) {mPending.setBlendFunction(src, dest);}
+  void    setDepthMask(GLboolean value)   {mPending.setDepthMask(value);}
+  void    setColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
+                                          {mPending.setColorMask(red, green, blue, alpha);}
+  void    setLineWidth(float width)       {mPending.setLineWidth(width);}
+  void    setActiveTexture(GLenum value)  {mPending.setActiveTexture(value);}
+  /// @}
+
+  /// State that was last sent to OpenGL. Only meaningful if hasFlushedState()
+  /// returns true.
+  const GLState&  getFlushedState() const {return mFlushed;}
+  bool            hasFlushedState() const {return mHasFlushed;}
+
+  /// Replaces the pending state entirely.
+  void setPending(const GLState& state)   {mPending = state;}
+
+  /// Informs this object of the current OpenGL state (usually obtained via
+  /// GLState::readStateFromOpenGL). Subsequent flushes are relative to it.
+  void setFlushedState(const GLState& state);
+
+  /// Forgets the flushed state. Call this when OpenGL state was modified
+  /// outside of this object. The next flush() applies the entire pending
+  /// state.
+  void invalidate()                       {mHasFlushed = false;}
+
+  /// Returns true if the pending state differs from the flushed state
+  /// (per GLState::operator==) or no state has been flushed yet. When this
+  /// returns false, flush() issues no OpenGL calls and may be skipped.
+  bool isDirty() const;
+
+  /// Applies the pending state to OpenGL relative to the last flushed state
+  /// and records the pending state as flushed.
+  void flush();
+
+private:
+
+  GLState     mPending;     ///< State to apply on the next flush.
+  GLState     mFlushed;     ///< State last applied to OpenGL.
+  bool        mHasFlushed;  ///< True if mFlushed reflects OpenGL state.
+};
+
+} // namespace CPM_GL_STATE_NS 
+
+#endif 
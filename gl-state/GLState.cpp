@@ -255,7 +255,7 @@ void GLState::applyDepthMask(bool force, const GLState* cur) const
 //------------------------------------------------------------------------------
 void GLState::applyLineWidth(bool force, const GLState* cur) const
 {
-  if (force || (cur && cur->mLineWidth != mLineWidth))
+  if (force || (cur && !areFloatSame(cur->mLineWidth, mLineWidth)))
   {
     GL(glLineWidth(mLineWidth));
   }
@@ -5,6 +5,7 @@
 #include <batch-testing/SpireTestFixture.hpp>
 
 #include <gl-state/GLState.hpp>
+#include <gl-state/GLDeferredState.hpp>
 
 using namespace CPM_BATCH_TESTING_NS;
 using namespace CPM_GL_STATE_NS;
@@ -187,3 +188,70 @@ TEST_F(SpireTestFixture, TestGLState)
   // changed when we perform applyRelative .
 }
 
+
+TEST_F(SpireTestFixture, TestGLDeferredState)
+{
+  GLState defaultState;
+  defaultState.readStateFromOpenGL();
+  defaultState.apply();
+
+  auto testStateAgainstOpenGL = [](const GLState& state)
+  {
+    GLState curState;
+    curState.readStateFromOpenGL();
+    return curState == state;
+  };
+
+  GLDeferredState deferred;
+  EXPECT_EQ(true, deferred.isDirty());
+  deferred.setPending(defaultState);
+  deferred.setFlushedState(defaultState);
+  EXPECT_EQ(false, deferred.isDirty());
+
+  // Changes must not reach OpenGL before flush.
+  deferred.setDepthFunc(GL_NEVER);
+  deferred.setBlendEnable(!defaultState.getBlendEnable());
+  deferred.setLineWidth(1.5f);
+  EXPECT_EQ(true, deferred.isDirty());
+  EXPECT_EQ(true, testStateAgainstOpenGL(defaultState));
+
+  deferred.flush();
+  EXPECT_EQ(false, deferred.isDirty());
+  EXPECT_EQ(true, testStateAgainstOpenGL(deferred.getPending()));
+
+  // Toggling a field back and forth between flushes is a no-op. The depth
+  // func set behind the object's back must survive the flush.
+  GLState flushedState = deferred.getPending();
+  deferred.setCullFaceEnable(!defaultState.getCullFaceEnable());
+  deferred.setCullFaceEnable(defaultState.getCullFaceEnable());
+  EXPECT_EQ(false, deferred.isDirty());
+  GL(glDepthFunc(GL_ALWAYS));
+  deferred.flush();
+  flushedState.setDepthFunc(GL_ALWAYS);
+  EXPECT_EQ(true, testStateAgainstOpenGL(flushedState));
+
+  // Restore the default state through the deferred path.
+  deferred.setPending(defaultState);
+  deferred.flush();
+  EXPECT_EQ(true, testStateAgainstOpenGL(defaultState));
+
+  // Only the net delta is applied: fields that did not change in the
+  // pending state are not re-sent, so a change made directly to OpenGL
+  // survives the flush.
+  deferred.setFlushedState(defaultState);
+  GL(glDepthFunc(GL_ALWAYS));
+  deferred.setBlendEnable(!defaultState.getBlendEnable());
+  deferred.flush();
+  GLState glState;
+  glState.readStateFromOpenGL();
+  EXPECT_EQ(static_cast<GLenum>(GL_ALWAYS), glState.getDepthFunc());
+  EXPECT_EQ(!defaultState.getBlendEnable(), glState.getBlendEnable());
+
+  // After invalidation the entire pending state is applied.
+  deferred.setPending(defaultState);
+  GL(glDepthFunc(GL_ALWAYS));
+  deferred.invalidate();
+  EXPECT_EQ(true, deferred.isDirty());
+  deferred.flush();
+  EXPECT_EQ(true, testStateAgainstOpenGL(defaultState));
+}